@@ -0,0 +1,118 @@
+#pragma once
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Table-driven command line parsing shared by the benchmark tools. Each tool
+// lists its flags once; the same table parses argv and prints the usage.
+// Numeric values must be whole, in range and finite, or parsing fails.
+
+inline bool parseNumber(const char* text, double& value) {
+    char* end = nullptr;
+    errno = 0;
+    double parsed = std::strtod(text, &end);
+    if (end == text || *end != '\0' || errno == ERANGE || !std::isfinite(parsed)) {
+        return false;
+    }
+    value = parsed;
+    return true;
+}
+
+inline bool parseNumber(const char* text, int& value) {
+    char* end = nullptr;
+    errno = 0;
+    long parsed = std::strtol(text, &end, 10);
+    if (end == text || *end != '\0' || errno == ERANGE || parsed < INT_MIN || parsed > INT_MAX) {
+        return false;
+    }
+    value = (int)parsed;
+    return true;
+}
+
+// "<w>x<h>", e.g. 1920x1080.
+inline bool parseSize(const char* text, int& width, int& height) {
+    std::string size = text;
+    size_t x = size.find('x');
+    if (x == std::string::npos) {
+        return false;
+    }
+    return parseNumber(size.substr(0, x).c_str(), width) && parseNumber(size.substr(x + 1).c_str(), height);
+}
+
+struct CommandLineFlag {
+    std::string name;       // e.g. "--fps"
+    std::string valueName;  // e.g. "<n>"; empty for switches, which take no value
+    std::string help;
+    std::function<bool(const char*)> parse;
+
+    template <typename T>
+    static CommandLineFlag number(const char* name, const char* valueName, const char* help, T& target) {
+        return {name, valueName, help, [&target](const char* text) { return parseNumber(text, target); }};
+    }
+
+    static CommandLineFlag text(const char* name, const char* valueName, const char* help,
+                                std::string& target) {
+        return {name, valueName, help, [&target](const char* text) {
+                    target = text;
+                    return true;
+                }};
+    }
+
+    static CommandLineFlag size(const char* name, const char* help, int& width, int& height) {
+        return {name, "<w>x<h>", help,
+                [&width, &height](const char* text) { return parseSize(text, width, height); }};
+    }
+
+    static CommandLineFlag toggle(const char* name, const char* help, bool& target, bool value) {
+        return {name, "", help, [&target, value](const char*) {
+                    target = value;
+                    return true;
+                }};
+    }
+};
+
+// Applies every flag in argv; the last non-flag argument is stored in
+// positional. Returns false on an unknown flag, a missing value or a value
+// its flag rejects.
+inline bool parseCommandLine(int argc, char* argv[], const std::vector<CommandLineFlag>& flags,
+                             std::string& positional) {
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg.rfind("--", 0) != 0) {
+            positional = arg;
+            continue;
+        }
+
+        auto flag = std::find_if(flags.begin(), flags.end(),
+                                 [&](const CommandLineFlag& f) { return f.name == arg; });
+        if (flag == flags.end()) {
+            return false;
+        }
+        if (flag->valueName.empty()) {
+            flag->parse(nullptr);
+        } else if (i + 1 >= argc || !flag->parse(argv[++i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+inline void printCommandLineUsage(const char* program, const std::vector<CommandLineFlag>& flags) {
+    size_t column = 0;
+    for (const CommandLineFlag& flag : flags) {
+        column = std::max(column, flag.name.size() + 1 + flag.valueName.size());
+    }
+
+    std::cout << "Usage: " << program << " [file.riv] [options]" << std::endl;
+    for (const CommandLineFlag& flag : flags) {
+        std::string left = flag.valueName.empty() ? flag.name : flag.name + " " + flag.valueName;
+        std::cout << "  " << left << std::string(column - left.size() + 2, ' ') << flag.help << std::endl;
+    }
+}
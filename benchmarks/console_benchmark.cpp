@@ -3,71 +3,96 @@
 #include <vector>
 #include <chrono>
 #include <thread>
+#include <iterator>
 
 // Include Rive headers
 #include "rive/file.hpp"
 #include "rive/animation/linear_animation_instance.hpp"
 #include "rive/factory.hpp"
 #include "utils/no_op_factory.hpp"
+#include "rive_file_cache.hpp"
+#include "memory_stats.hpp"
+#include "command_line.hpp"
 
 int main(int argc, char* argv[]) {
     std::string riveFile = "fire_button.riv";
-    if (argc > 1) {
-        riveFile = argv[1];
+    int instanceCount = 1;
+    std::vector<CommandLineFlag> flags = {
+        CommandLineFlag::number("--instances", "<n>", "Artboard instances sharing the file (default: 1)", instanceCount),
+    };
+    if (!parseCommandLine(argc, argv, flags, riveFile) || instanceCount < 1) {
+        printCommandLineUsage(argv[0], flags);
+        return -1;
     }
     
     std::cout << "Rive Console Performance Benchmark" << std::endl;
-    std::cout << "Loading: " << riveFile << std::endl;
+    std::cout << "Loading: " << riveFile << " (" << instanceCount << " instances)" << std::endl;
     
     try {
-        // Load the .riv file
-        std::ifstream file(riveFile, std::ios::binary);
-        if (!file) {
-            std::cerr << "Failed to open Rive file: " << riveFile << std::endl;
-            return -1;
-        }
-        
-        file.seekg(0, std::ios::end);
-        size_t length = file.tellg();
-        file.seekg(0, std::ios::beg);
-        
-        std::vector<uint8_t> bytes(length);
-        file.read(reinterpret_cast<char*>(bytes.data()), length);
-        file.close();
+        auto requestTime = std::chrono::high_resolution_clock::now();
         
-        // Import the Rive file
+        // Every instance requests its own file, as independent widgets would;
+        // the cache imports it once on its loader thread and shares it
         rive::NoOpFactory factory;
-        auto riveFilePtr = rive::File::import(rive::Span<const uint8_t>(bytes.data(), bytes.size()), &factory);
-        if (!riveFilePtr) {
-            std::cerr << "Failed to import Rive file" << std::endl;
-            return -1;
+        RiveFileCache cache(&factory);
+        std::vector<std::shared_future<RiveFileCache::Entry>> pending;
+        for (int i = 0; i < instanceCount; i++) {
+            pending.push_back(cache.load(riveFile));
+        }
+        
+        std::vector<RiveFileCache::Entry> files;
+        std::vector<std::unique_ptr<rive::ArtboardInstance>> artboards;
+        std::vector<std::unique_ptr<rive::LinearAnimationInstance>> animations;
+        for (auto& request : pending) {
+            files.push_back(request.get());
+            
+            // Get the artboard
+            auto instance = files.back()->instanceDefault();
+            if (!instance) {
+                std::cerr << "No artboard found in Rive file" << std::endl;
+                return -1;
+            }
+            
+            if (instance->animationCount() > 0) {
+                auto instanceAnimation = instance->animationAt(0);
+                instanceAnimation->time(0);
+                instanceAnimation->apply();
+                animations.push_back(std::move(instanceAnimation));
+            }
+            artboards.push_back(std::move(instance));
         }
+        double loadWait = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - requestTime).count();
         
-        // Get the artboard
-        auto artboard = riveFilePtr->artboardDefault();
-        if (!artboard) {
-            std::cerr << "No artboard found in Rive file" << std::endl;
-            return -1;
+        // Heap deltas are process-wide, so measure one import's footprint with
+        // a throwaway synchronous import now that the loader thread is idle
+        size_t importFootprint = 0;
+        {
+            std::ifstream file(riveFile, std::ios::binary);
+            std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+            size_t heapBefore = heapStats().inUse;
+            auto reference = rive::File::import(rive::Span<const uint8_t>(bytes.data(), bytes.size()), &factory);
+            size_t heapAfter = heapStats().inUse;
+            if (reference && heapAfter > heapBefore) {
+                importFootprint = heapAfter - heapBefore;
+            }
         }
         
+        rive::ArtboardInstance* artboard = artboards.front().get();
         std::cout << "Artboard loaded: " << artboard->name() << std::endl;
         std::cout << "Dimensions: " << artboard->width() << " x " << artboard->height() << std::endl;
         std::cout << "Animation count: " << artboard->animationCount() << std::endl;
         
         // Get the first animation
-        std::unique_ptr<rive::LinearAnimationInstance> animation;
-        if (artboard->animationCount() > 0) {
-            animation = artboard->animationAt(0);
-            animation->time(0);
-            animation->apply();
+        if (!animations.empty()) {
             std::cout << "Animation loaded: " << artboard->animation(0)->name() << std::endl;
-            std::cout << "Duration: " << animation->durationSeconds() << " seconds" << std::endl;
+            std::cout << "Duration: " << animations.front()->durationSeconds() << " seconds" << std::endl;
         }
         
         // Performance test without renderer
         std::cout << "\nRunning 5-second CPU performance test..." << std::endl;
         std::cout << "This tests pure Rive animation processing speed" << std::endl;
         
+        double timeToFirstFrame = 0.0;
         int frameCount = 0;
         double totalTime = 0.0;
         double minFrameTime = std::numeric_limits<double>::max();
@@ -79,17 +104,22 @@ int main(int argc, char* argv[]) {
         while ((std::chrono::high_resolution_clock::now() - startTime) < testDuration) {
             auto frameStart = std::chrono::high_resolution_clock::now();
             
-            // Update animation
-            if (animation) {
+            // Update animations
+            for (auto& animation : animations) {
                 animation->advance(1.0 / 60.0); // Advance by 1/60th of a second
                 animation->apply();
             }
             
-            // Process artboard (CPU work only, no rendering)
+            // Process artboards (CPU work only, no rendering)
             // This simulates the CPU processing that would happen before GPU/OpenVG rendering
-            artboard->advance(1.0 / 60.0);
+            for (auto& instance : artboards) {
+                instance->advance(1.0 / 60.0);
+            }
             
             auto frameEnd = std::chrono::high_resolution_clock::now();
+            if (frameCount == 0) {
+                timeToFirstFrame = std::chrono::duration<double>(frameEnd - requestTime).count();
+            }
             double frameTime = std::chrono::duration<double>(frameEnd - frameStart).count();
             
             totalTime += frameTime;
@@ -117,6 +147,21 @@ int main(int argc, char* argv[]) {
         std::cout << "Average Frame Time: " << (totalTime / frameCount) * 1000 << " ms" << std::endl;
         std::cout << "===============================" << std::endl;
         
+        const CachedRiveFile& cached = *files.front();
+        RiveFileCacheStats cacheStats = cache.stats();
+        std::cout << "\n=== FILE CACHE RESULTS ===" << std::endl;
+        std::cout << "Time To First Frame: " << timeToFirstFrame * 1000 << " ms"
+                  << " (load wait: " << loadWait * 1000 << " ms, import: " << cached.importSeconds * 1000 << " ms)" << std::endl;
+        std::cout << "Requests: " << cacheStats.requests << " | Disk Reads: " << cacheStats.reads
+                  << " | Imports: " << cacheStats.imports
+                  << " | Hits: " << cacheStats.hits << std::endl;
+        std::cout << "Import Footprint: " << importFootprint / 1024.0 << " KB per file ("
+                  << cached.fileBytes / 1024.0 << " KB on disk)" << std::endl;
+        std::cout << "Memory Saved vs Per-Instance Imports: "
+                  << (cacheStats.requests - cacheStats.imports) * importFootprint / 1024.0 << " KB" << std::endl;
+        std::cout << "Resident Set Size: " << residentBytes() / (1024.0 * 1024.0) << " MB" << std::endl;
+        std::cout << "==========================" << std::endl;
+        
         std::cout << "\nThis shows pure CPU animation processing speed." << std::endl;
         std::cout << "GPU/OpenVG rendering would add additional time on top of these numbers." << std::endl;
         
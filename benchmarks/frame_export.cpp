@@ -0,0 +1,324 @@
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <atomic>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+
+// Include Rive headers
+#include "rive/file.hpp"
+#include "rive/layout.hpp"
+#include "rive/math/aabb.hpp"
+#include "rive/animation/linear_animation_instance.hpp"
+#include "rive/factory.hpp"
+#include "software_renderer.hpp"
+#include "rive_file_cache.hpp"
+#include "command_line.hpp"
+
+// Offline frame exporter: renders an animation timeline to a frame sequence
+// using the headless software rasterizer, one worker thread per time range.
+
+struct EncodedFrame {
+    int index;
+    std::vector<uint8_t> data;
+};
+
+// Bounded hand-off between render workers and the single writer thread, so
+// encoded frames cannot pile up in memory faster than the disk absorbs them.
+class FrameQueue {
+private:
+    std::mutex mutex;
+    std::condition_variable notFull;
+    std::condition_variable notEmpty;
+    std::deque<EncodedFrame> frames;
+    size_t capacity;
+    bool closed = false;
+
+public:
+    explicit FrameQueue(size_t maxFrames) : capacity(std::max<size_t>(maxFrames, 1)) {}
+
+    // Blocks while the queue is full; returns the time spent waiting.
+    double push(EncodedFrame frame) {
+        auto waitStart = std::chrono::high_resolution_clock::now();
+        std::unique_lock<std::mutex> lock(mutex);
+        notFull.wait(lock, [this] { return frames.size() < capacity; });
+        auto waitEnd = std::chrono::high_resolution_clock::now();
+        frames.push_back(std::move(frame));
+        lock.unlock();
+        notEmpty.notify_one();
+        return std::chrono::duration<double>(waitEnd - waitStart).count();
+    }
+
+    // Returns false once the queue is closed and drained.
+    bool pop(EncodedFrame& frame) {
+        std::unique_lock<std::mutex> lock(mutex);
+        notEmpty.wait(lock, [this] { return !frames.empty() || closed; });
+        if (frames.empty()) {
+            return false;
+        }
+        frame = std::move(frames.front());
+        frames.pop_front();
+        lock.unlock();
+        notFull.notify_one();
+        return true;
+    }
+
+    void close() {
+        std::lock_guard<std::mutex> lock(mutex);
+        closed = true;
+        notEmpty.notify_all();
+    }
+};
+
+struct ExportOptions {
+    std::string riveFile = "fire_button.riv";
+    std::string outputDir = "frames";
+    std::string format = "png"; // png | rgba
+    int width = 0;              // 0 = artboard size
+    int height = 0;
+    double fps = 60.0;
+    int threads = 0;            // 0 = hardware concurrency
+    int animationIndex = 0;
+    int queueDepth = 16;
+    bool write = true;
+};
+
+struct WorkerStats {
+    int firstFrame = 0;
+    int frameCount = 0;
+    double renderTime = 0.0;
+    double encodeTime = 0.0;
+    double queueWaitTime = 0.0;
+    uint32_t unsupportedFeatures = 0;
+};
+
+static std::vector<CommandLineFlag> exportFlags(ExportOptions& options) {
+    return {
+        CommandLineFlag::text("--out", "<dir>", "Output directory (default: frames)", options.outputDir),
+        CommandLineFlag::text("--format", "png|rgba", "Frame format (default: png)", options.format),
+        CommandLineFlag::size("--size", "Output size (default: artboard size)", options.width, options.height),
+        CommandLineFlag::number("--fps", "<n>", "Frames per second of animation time (default: 60)", options.fps),
+        CommandLineFlag::number("--threads", "<n>", "Render workers (default: all cores)", options.threads),
+        CommandLineFlag::number("--animation", "<i>", "Animation index (default: 0)", options.animationIndex),
+        CommandLineFlag::number("--queue", "<n>", "Writer queue depth in frames (default: 16)", options.queueDepth),
+        CommandLineFlag::toggle("--no-write", "Render and encode only, skip disk writes", options.write, false),
+    };
+}
+
+static bool parseOptions(int argc, char* argv[], ExportOptions& options) {
+    if (!parseCommandLine(argc, argv, exportFlags(options), options.riveFile)) {
+        return false;
+    }
+    return (options.format == "png" || options.format == "rgba") && options.fps > 0 && options.queueDepth > 0;
+}
+
+int main(int argc, char* argv[]) {
+    ExportOptions options;
+    if (!parseOptions(argc, argv, options)) {
+        printCommandLineUsage(argv[0], exportFlags(options));
+        return -1;
+    }
+
+    std::cout << "Rive Offline Frame Export" << std::endl;
+    std::cout << "Loading: " << options.riveFile << std::endl;
+
+    try {
+        // Import the Rive file with a factory that keeps path geometry; all
+        // workers instance their artboards from this one shared file
+        SoftwareFactory factory;
+        RiveFileCache cache(&factory);
+        RiveFileCache::Entry riveFile = cache.load(options.riveFile).get();
+
+        // Probe artboard to size the export and find the timeline length
+        auto artboard = riveFile->instanceDefault();
+        if (!artboard) {
+            std::cerr << "No artboard found in Rive file" << std::endl;
+            return -1;
+        }
+        if (options.animationIndex < 0 || size_t(options.animationIndex) >= artboard->animationCount()) {
+            std::cerr << "Animation index " << options.animationIndex << " out of range (count: "
+                      << artboard->animationCount() << ")" << std::endl;
+            return -1;
+        }
+
+        auto animation = artboard->animationAt(options.animationIndex);
+        double duration = animation->durationSeconds();
+        int totalFrames = std::max(1, (int)std::ceil(duration * options.fps));
+
+        if (options.width <= 0 || options.height <= 0) {
+            options.width = std::max(1, (int)std::ceil(artboard->width()));
+            options.height = std::max(1, (int)std::ceil(artboard->height()));
+        }
+
+        int threadCount = options.threads > 0 ? options.threads : (int)std::thread::hardware_concurrency();
+        threadCount = std::max(1, std::min(threadCount, totalFrames));
+
+        std::cout << "Artboard loaded: " << artboard->name() << std::endl;
+        std::cout << "Animation: " << artboard->animation(options.animationIndex)->name()
+                  << " (" << duration << " seconds)" << std::endl;
+        std::cout << "Exporting " << totalFrames << " frames at " << options.width << " x " << options.height
+                  << " (" << options.format << ") with " << threadCount << " worker threads" << std::endl;
+
+        if (options.write) {
+            std::filesystem::create_directories(options.outputDir);
+        }
+
+        FrameQueue queue(options.queueDepth);
+        std::vector<WorkerStats> stats(threadCount);
+
+        // First failure from any thread; the others stop at their next frame.
+        // An exception escaping a std::thread would terminate the process.
+        std::atomic<bool> failed(false);
+        std::mutex failureMutex;
+        std::string failure;
+        auto reportFailure = [&](const std::string& message) {
+            std::lock_guard<std::mutex> lock(failureMutex);
+            if (!failed.exchange(true)) {
+                failure = message;
+            }
+        };
+
+        // Single writer drains the queue in arrival order; it keeps draining
+        // after a failure so no worker blocks on a full queue
+        size_t bytesWritten = 0;
+        double writeTime = 0.0;
+        std::thread writer([&] {
+            EncodedFrame frame;
+            while (queue.pop(frame)) {
+                if (!options.write || failed) {
+                    continue;
+                }
+                try {
+                    auto writeStart = std::chrono::high_resolution_clock::now();
+                    char name[32];
+                    std::snprintf(name, sizeof(name), "frame_%05d.%s", frame.index, options.format.c_str());
+                    std::filesystem::path framePath = std::filesystem::path(options.outputDir) / name;
+                    std::ofstream out(framePath, std::ios::binary);
+                    out.write(reinterpret_cast<const char*>(frame.data.data()), frame.data.size());
+                    if (!out) {
+                        reportFailure("Failed to write " + framePath.string());
+                    }
+                    bytesWritten += frame.data.size();
+                    writeTime += std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - writeStart).count();
+                } catch (const std::exception& e) {
+                    reportFailure(std::string("Writer: ") + e.what());
+                }
+            }
+        });
+
+        auto startTime = std::chrono::high_resolution_clock::now();
+
+        // Contiguous time range per worker
+        std::vector<std::thread> workers;
+        for (int w = 0; w < threadCount; w++) {
+            WorkerStats& workerStats = stats[w];
+            workerStats.firstFrame = (int)((long long)totalFrames * w / threadCount);
+            workerStats.frameCount = (int)((long long)totalFrames * (w + 1) / threadCount) - workerStats.firstFrame;
+
+            workers.emplace_back([&, w] {
+                WorkerStats& s = stats[w];
+                try {
+                    auto workerArtboard = riveFile->instanceDefault();
+                    auto workerAnimation = workerArtboard->animationAt(options.animationIndex);
+                    double startSeconds = workerAnimation->animation()->startSeconds();
+                    double endSeconds = workerAnimation->animation()->endSeconds();
+
+                    Framebuffer frame(options.width, options.height);
+                    SoftwareRenderer renderer(frame);
+                    rive::Mat2D viewTransform = rive::computeAlignment(
+                        rive::Fit::contain, rive::Alignment::center,
+                        rive::AABB(0, 0, options.width, options.height), workerArtboard->bounds());
+
+                    for (int i = s.firstFrame; i < s.firstFrame + s.frameCount && !failed; i++) {
+                        auto renderStart = std::chrono::high_resolution_clock::now();
+
+                        // Seek rather than advance so every range is independent; times
+                        // are absolute, so offset into the animation's work area
+                        workerAnimation->time(std::min(startSeconds + i / options.fps, endSeconds));
+                        workerAnimation->apply();
+                        workerArtboard->advance(0.0f);
+
+                        frame.clear(0x00000000);
+                        renderer.save();
+                        renderer.transform(viewTransform);
+                        workerArtboard->draw(&renderer);
+                        renderer.restore();
+
+                        auto encodeStart = std::chrono::high_resolution_clock::now();
+                        EncodedFrame encoded{i, options.format == "png" ? encodePNG(frame) : frame.pixels};
+                        auto encodeEnd = std::chrono::high_resolution_clock::now();
+
+                        s.renderTime += std::chrono::duration<double>(encodeStart - renderStart).count();
+                        s.encodeTime += std::chrono::duration<double>(encodeEnd - encodeStart).count();
+                        s.queueWaitTime += queue.push(std::move(encoded));
+                    }
+                    s.unsupportedFeatures = renderer.unsupportedFeatures();
+                } catch (const std::exception& e) {
+                    reportFailure("Worker " + std::to_string(w) + ": " + e.what());
+                } catch (...) {
+                    reportFailure("Worker " + std::to_string(w) + ": unknown error");
+                }
+            });
+        }
+
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        auto renderEndTime = std::chrono::high_resolution_clock::now();
+        queue.close();
+        writer.join();
+        auto endTime = std::chrono::high_resolution_clock::now();
+
+        if (failed) {
+            std::cerr << "Export failed: " << failure << std::endl;
+            return -1;
+        }
+
+        double renderDuration = std::chrono::duration<double>(renderEndTime - startTime).count();
+        double actualDuration = std::chrono::duration<double>(endTime - startTime).count();
+        double framesPerSecond = totalFrames / actualDuration;
+        // Workers beyond the core count share cores, so divide by cores in use
+        int hardwareThreads = (int)std::thread::hardware_concurrency();
+        int coresUsed = hardwareThreads > 0 ? std::min(threadCount, hardwareThreads) : threadCount;
+
+        std::cout << "\n=== FRAME EXPORT RESULTS ===" << std::endl;
+        for (int w = 0; w < threadCount; w++) {
+            const WorkerStats& s = stats[w];
+            std::cout << "Worker " << w << ": frames " << s.firstFrame << "-" << s.firstFrame + s.frameCount - 1
+                      << " | Render: " << s.renderTime * 1000 << " ms"
+                      << " | Encode: " << s.encodeTime * 1000 << " ms"
+                      << " | Queue Wait: " << s.queueWaitTime * 1000 << " ms" << std::endl;
+        }
+        std::cout << "Total Frames: " << totalFrames << std::endl;
+        std::cout << "Render Duration: " << renderDuration << " seconds" << std::endl;
+        std::cout << "Total Duration: " << actualDuration << " seconds" << std::endl;
+        std::cout << "Write Time: " << writeTime << " seconds (" << bytesWritten / (1024.0 * 1024.0) << " MB)" << std::endl;
+        std::cout << "Frames Per Second: " << framesPerSecond << std::endl;
+        std::cout << "Frames Per Second Per Core: " << framesPerSecond / coresUsed
+                  << " (" << coresUsed << " cores)" << std::endl;
+        std::cout << "============================" << std::endl;
+
+        uint32_t unsupported = 0;
+        for (const WorkerStats& s : stats) {
+            unsupported |= s.unsupportedFeatures;
+        }
+        if (unsupported) {
+            std::cerr << "Warning: frames differ from the Rive runtime; unsupported by the software renderer: "
+                      << SoftwareRenderer::describeUnsupported(unsupported) << std::endl;
+        }
+
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return -1;
+    }
+
+    return 0;
+}
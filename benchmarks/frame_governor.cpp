@@ -0,0 +1,72 @@
+#include "frame_governor.hpp"
+#include "frame_stats.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+FrameGovernor::FrameGovernor(double frameBudgetSeconds, size_t size)
+    : windowSize(std::max<size_t>(size, 1)), frameBudget(frameBudgetSeconds) {
+    levels = {
+        {"full",            0.25f, true,  1.0f, 1},
+        {"coarse-curves",   1.0f,  true,  1.0f, 1},
+        {"no-antialias",    1.0f,  false, 1.0f, 1},
+        {"half-resolution", 1.0f,  false, 0.5f, 1},
+        {"reduced-updates", 1.0f,  false, 0.5f, 2},
+    };
+    window.reserve(windowSize);
+}
+
+double FrameGovernor::percentile(double p) const {
+    std::vector<double> sorted(window);
+    return ::percentile(sorted, p);
+}
+
+bool FrameGovernor::addFrame(double frameTime) {
+    window.push_back(frameTime);
+    if (window.size() < windowSize) {
+        return false;
+    }
+
+    size_t previous = current;
+    if (percentile(90) > frameBudget) {
+        healthyWindows = 0;
+        if (windowsSinceStepUp >= 0) {
+            // The better level still does not fit; back off before retrying it
+            windowsBeforeStepUp = std::min(windowsBeforeStepUp * 2, kMaxWindowsBeforeStepUp);
+            windowsSinceStepUp = -1;
+        }
+        if (current + 1 < levels.size()) {
+            transition(current + 1, "p90 over budget");
+        }
+    } else {
+        if (windowsSinceStepUp >= 0 && ++windowsSinceStepUp >= kWindowsBeforeStepUp) {
+            windowsBeforeStepUp = kWindowsBeforeStepUp;
+            windowsSinceStepUp = -1;
+        }
+        if (percentile(99) < frameBudget * kHeadroom) {
+            if (++healthyWindows >= windowsBeforeStepUp && current > 0) {
+                transition(current - 1, "headroom recovered");
+                windowsSinceStepUp = 0;
+            }
+        } else {
+            healthyWindows = 0;
+        }
+    }
+
+    // Each decision is based on frames rendered entirely at one level
+    window.clear();
+    return current != previous;
+}
+
+void FrameGovernor::transition(size_t next, const char* reason) {
+    std::cout << "GOVERNOR: " << levels[current].name << " -> " << levels[next].name
+              << " (" << reason << ")"
+              << " | p50: " << percentile(50) * 1000 << "ms"
+              << " | p90: " << percentile(90) * 1000 << "ms"
+              << " | p99: " << percentile(99) * 1000 << "ms"
+              << " | Budget: " << frameBudget * 1000 << "ms" << std::endl;
+    current = next;
+    healthyWindows = 0;
+    transitions++;
+}
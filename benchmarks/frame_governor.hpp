@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+// Quality settings applied by the governor, ordered from best to cheapest.
+struct QualityLevel {
+    const char* name;
+    float flatteningTolerance;  // pixels
+    bool antialias;
+    float renderScale;          // fraction of window resolution, upscaled on present
+    int offFocusUpdateDivisor;  // advance animations every Nth frame while unfocused
+};
+
+// Adaptive quality governor. It collects frame times in a tumbling window
+// (cleared after each decision, so every window is measured at one level) and
+// compares its percentiles against the frame budget: it steps down one level
+// when p90 exceeds the budget and steps back up after consecutive windows
+// whose p99 leaves clear headroom. A step-up that is undone within that many
+// windows doubles the wait before the next one, so a level just over budget
+// is not retried every few windows. Every transition is logged to stdout.
+class FrameGovernor {
+public:
+    explicit FrameGovernor(double frameBudgetSeconds, size_t windowSize = 60);
+
+    // Records one frame's work time. Returns true if the quality level changed.
+    bool addFrame(double frameTime);
+
+    const QualityLevel& level() const { return levels[current]; }
+    size_t levelIndex() const { return current; }
+    size_t levelCount() const { return levels.size(); }
+    double budget() const { return frameBudget; }
+    int transitionCount() const { return transitions; }
+
+    // Percentile (0-100) of the frames in the current window.
+    double percentile(double p) const;
+
+private:
+    std::vector<QualityLevel> levels;
+    std::vector<double> window;
+    size_t windowSize;
+    size_t current = 0;
+    double frameBudget;
+    int healthyWindows = 0;
+    int transitions = 0;
+    int windowsBeforeStepUp = kWindowsBeforeStepUp;
+    int windowsSinceStepUp = -1;  // -1 once the last step-up has held
+
+    // p99 must stay below this fraction of the budget to step back up...
+    static constexpr double kHeadroom = 0.6;
+    // ...for this many consecutive windows, doubled per failed step-up.
+    static constexpr int kWindowsBeforeStepUp = 3;
+    static constexpr int kMaxWindowsBeforeStepUp = 48;
+
+    void transition(size_t next, const char* reason);
+};
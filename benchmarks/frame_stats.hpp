@@ -0,0 +1,17 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+// Nearest-rank percentile (p in 0-100) of a set of frame times. Partially
+// reorders values; returns 0 when empty.
+inline double percentile(std::vector<double>& values, double p) {
+    if (values.empty()) {
+        return 0.0;
+    }
+    double rank = std::max(0.0, std::ceil(p / 100.0 * values.size()) - 1);
+    size_t index = std::min(values.size() - 1, (size_t)rank);
+    std::nth_element(values.begin(), values.begin() + index, values.end());
+    return values[index];
+}
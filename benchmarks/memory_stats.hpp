@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstddef>
+#include <fstream>
+#include <unistd.h>
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+// Process memory probes (Linux). Both return 0 when unavailable.
+
+// Resident set size in bytes, from /proc/self/statm.
+inline size_t residentBytes() {
+    std::ifstream statm("/proc/self/statm");
+    size_t totalPages = 0;
+    size_t residentPages = 0;
+    if (!(statm >> totalPages >> residentPages)) {
+        return 0;
+    }
+    return residentPages * (size_t)sysconf(_SC_PAGESIZE);
+}
+
+// Heap statistics from the C allocator.
+struct HeapStats {
+    size_t inUse = 0;     // bytes handed out by malloc
+    size_t free = 0;      // bytes held by the allocator but not in use
+    size_t mapped = 0;    // bytes in mmap'd chunks
+};
+
+inline HeapStats heapStats() {
+    HeapStats stats;
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+    struct mallinfo2 info = mallinfo2();
+    stats.inUse = info.uordblks + info.hblkhd;
+    stats.free = info.fordblks;
+    stats.mapped = info.hblkhd;
+#elif defined(__GLIBC__)
+    struct mallinfo info = mallinfo();
+    stats.inUse = (size_t)(unsigned)info.uordblks + (size_t)(unsigned)info.hblkhd;
+    stats.free = (size_t)(unsigned)info.fordblks;
+    stats.mapped = (size_t)(unsigned)info.hblkhd;
+#endif
+    return stats;
+}
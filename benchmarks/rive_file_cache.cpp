@@ -0,0 +1,159 @@
+#include "rive_file_cache.hpp"
+
+#include <chrono>
+#include <fstream>
+#include <stdexcept>
+
+std::unique_ptr<rive::ArtboardInstance> CachedRiveFile::instanceDefault() const {
+    std::lock_guard<std::mutex> lock(instanceMutex);
+    return file->artboardDefault();
+}
+
+RiveFileCache::RiveFileCache(rive::Factory* riveFactory) : factory(riveFactory) {
+    loader = std::thread(&RiveFileCache::loaderMain, this);
+}
+
+RiveFileCache::~RiveFileCache() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    requestReady.notify_one();
+    loader.join();
+}
+
+std::shared_future<RiveFileCache::Entry> RiveFileCache::load(const std::string& path) {
+    Request request;
+    request.path = path;
+    std::shared_future<Entry> result = request.promise.get_future().share();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        counters.requests++;
+        requests.push_back(std::move(request));
+    }
+    requestReady.notify_one();
+    return result;
+}
+
+RiveFileCacheStats RiveFileCache::stats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return counters;
+}
+
+RiveContentHash RiveFileCache::hashContents(const std::vector<uint8_t>& bytes) {
+    // 128-bit state as 32-bit limbs, least significant first, so the
+    // multiply's carries fit in uint64_t
+    uint32_t h[4] = {0x6295c58du, 0x62b82175u, 0x07bb0142u, 0x6c62272eu};
+    for (uint8_t byte : bytes) {
+        h[0] ^= byte;
+
+        // h *= 2^88 + 0x13B (mod 2^128): h * 0x13B plus h shifted left 88 bits
+        uint32_t product[4];
+        uint64_t carry = 0;
+        for (int i = 0; i < 4; i++) {
+            uint64_t t = uint64_t(h[i]) * 0x13Bu + carry;
+            product[i] = uint32_t(t);
+            carry = t >> 32;
+        }
+        uint64_t t2 = uint64_t(product[2]) + (uint64_t(h[0] & 0xFFu) << 24);
+        uint64_t t3 = uint64_t(product[3]) + (t2 >> 32) + uint32_t((h[0] >> 8) | (h[1] << 24));
+        h[0] = product[0];
+        h[1] = product[1];
+        h[2] = uint32_t(t2);
+        h[3] = uint32_t(t3);
+    }
+
+    RiveContentHash hash;
+    hash.high = (uint64_t(h[3]) << 32) | h[2];
+    hash.low = (uint64_t(h[1]) << 32) | h[0];
+    return hash;
+}
+
+void RiveFileCache::loaderMain() {
+    for (;;) {
+        Request request;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            requestReady.wait(lock, [this] { return stopping || !requests.empty(); });
+            // Drain queued requests before stopping so no future is left unset
+            if (requests.empty()) {
+                return;
+            }
+            request = std::move(requests.front());
+            requests.pop_front();
+        }
+
+        try {
+            request.promise.set_value(resolve(request.path));
+        } catch (...) {
+            request.promise.set_exception(std::current_exception());
+        }
+    }
+}
+
+RiveFileCache::Entry RiveFileCache::resolve(const std::string& path) {
+    // Unchanged size and mtime since the last read: reuse the hash, skip the disk
+    std::error_code error;
+    uintmax_t size = std::filesystem::file_size(path, error);
+    std::filesystem::file_time_type modified;
+    if (!error) {
+        modified = std::filesystem::last_write_time(path, error);
+    }
+    if (!error) {
+        auto stamp = stamps.find(path);
+        if (stamp != stamps.end() && stamp->second.size == size && stamp->second.modified == modified) {
+            std::lock_guard<std::mutex> lock(mutex);
+            auto existing = files.find(stamp->second.contentHash);
+            if (existing != files.end()) {
+                counters.hits++;
+                return existing->second;
+            }
+        }
+    }
+
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        throw std::runtime_error("Failed to open Rive file: " + path);
+    }
+
+    file.seekg(0, std::ios::end);
+    size_t length = file.tellg();
+    file.seekg(0, std::ios::beg);
+
+    // Only needed while importing; the cache keeps the rive::File, not the bytes
+    std::vector<uint8_t> bytes(length);
+    file.read(reinterpret_cast<char*>(bytes.data()), length);
+    file.close();
+
+    auto entry = std::make_shared<CachedRiveFile>();
+    entry->contentHash = hashContents(bytes);
+    entry->fileBytes = length;
+    if (!error) {
+        stamps[path] = PathStamp{size, modified, entry->contentHash};
+    }
+
+    // Only this thread inserts, so a miss here cannot race with another import
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        counters.reads++;
+        auto existing = files.find(entry->contentHash);
+        if (existing != files.end()) {
+            counters.hits++;
+            return existing->second;
+        }
+    }
+
+    auto importStart = std::chrono::high_resolution_clock::now();
+    entry->file = rive::File::import(rive::Span<const uint8_t>(bytes.data(), bytes.size()), factory);
+    auto importEnd = std::chrono::high_resolution_clock::now();
+
+    if (!entry->file) {
+        throw std::runtime_error("Failed to import Rive file: " + path);
+    }
+    entry->importSeconds = std::chrono::duration<double>(importEnd - importStart).count();
+
+    std::lock_guard<std::mutex> lock(mutex);
+    counters.imports++;
+    files[entry->contentHash] = entry;
+    return entry;
+}
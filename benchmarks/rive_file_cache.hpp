@@ -0,0 +1,106 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "rive/file.hpp"
+#include "rive/factory.hpp"
+
+// Shared, deduplicated rive::File cache. Files are read and imported on a
+// single background loader thread and keyed by a 128-bit hash of their
+// contents, so every consumer of the same .riv (whatever its path) shares one
+// immutable rive::File and only creates its own artboard instances. Paths
+// whose size and modification time are unchanged skip the read and rehash.
+
+// Whatever rive::File::import hands back (rcp or unique_ptr, by version).
+using RiveFileHandle = decltype(rive::File::import(std::declval<rive::Span<const uint8_t>>(),
+                                                   std::declval<rive::Factory*>()));
+
+// FNV-1a 128-bit digest; wide enough that collisions can be ignored. Kept as
+// two 64-bit halves so no compiler-specific 128-bit integer is needed.
+struct RiveContentHash {
+    uint64_t high = 0;
+    uint64_t low = 0;
+
+    bool operator==(const RiveContentHash& other) const { return high == other.high && low == other.low; }
+    bool operator!=(const RiveContentHash& other) const { return !(*this == other); }
+    bool operator<(const RiveContentHash& other) const {
+        return high != other.high ? high < other.high : low < other.low;
+    }
+};
+
+struct CachedRiveFile {
+    RiveContentHash contentHash;
+    size_t fileBytes = 0;
+    RiveFileHandle file;
+    double importSeconds = 0.0;
+
+    // Instancing reads shared file state; one instance at a time per file.
+    std::unique_ptr<rive::ArtboardInstance> instanceDefault() const;
+
+private:
+    mutable std::mutex instanceMutex;
+};
+
+struct RiveFileCacheStats {
+    int requests = 0;
+    int reads = 0;                // requests that had to read and hash the file
+    int imports = 0;
+    int hits = 0;
+};
+
+class RiveFileCache {
+public:
+    using Entry = std::shared_ptr<const CachedRiveFile>;
+
+    // The factory must outlive the cache and every file it hands out.
+    explicit RiveFileCache(rive::Factory* factory);
+    ~RiveFileCache();
+
+    RiveFileCache(const RiveFileCache&) = delete;
+    RiveFileCache& operator=(const RiveFileCache&) = delete;
+
+    // Queues a load; the future holds the shared file, or the load error.
+    std::shared_future<Entry> load(const std::string& path);
+
+    RiveFileCacheStats stats() const;
+
+    static RiveContentHash hashContents(const std::vector<uint8_t>& bytes);
+
+private:
+    struct Request {
+        std::string path;
+        std::promise<Entry> promise;
+    };
+
+    // What a path held when it was last read.
+    struct PathStamp {
+        uintmax_t size;
+        std::filesystem::file_time_type modified;
+        RiveContentHash contentHash;
+    };
+
+    rive::Factory* factory;
+    std::thread loader;
+
+    mutable std::mutex mutex;
+    std::condition_variable requestReady;
+    std::deque<Request> requests;
+    std::map<RiveContentHash, std::shared_ptr<CachedRiveFile>> files;
+    std::map<std::string, PathStamp> stamps;  // loader thread only
+    RiveFileCacheStats counters;
+    bool stopping = false;
+
+    void loaderMain();
+    Entry resolve(const std::string& path);
+};
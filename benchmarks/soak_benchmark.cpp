@@ -0,0 +1,339 @@
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <chrono>
+#include <thread>
+#include <algorithm>
+#include <cmath>
+
+// Include Rive headers
+#include "rive/file.hpp"
+#include "rive/layout.hpp"
+#include "rive/math/aabb.hpp"
+#include "rive/animation/linear_animation_instance.hpp"
+#include "rive/factory.hpp"
+#include "utils/no_op_factory.hpp"
+#include "software_renderer.hpp"
+#include "rive_file_cache.hpp"
+#include "memory_stats.hpp"
+#include "frame_stats.hpp"
+#include "command_line.hpp"
+
+// Long-duration soak test: keeps a pool of artboard instances animating for
+// hours while recycling them to churn the allocator, samples memory and
+// latency at fixed intervals, and fails if the fitted trends show growth or
+// drift beyond the configured thresholds.
+
+struct SoakOptions {
+    std::string riveFile = "fire_button.riv";
+    double durationSeconds = 3600.0;
+    double sampleInterval = 10.0;
+    double warmupSeconds = -1.0;        // < 0 = 10% of duration, capped at 60 s
+    double fps = 60.0;                  // 0 = unpaced
+    int instances = 8;
+    int churnInterval = 30;             // frames between instance recycles, 0 = off
+    int renderWidth = 0;                // > 0 = rasterize each frame in software
+    int renderHeight = 0;
+    double maxRssGrowthMB = 1.0;        // per hour
+    double maxHeapGrowthMB = 1.0;       // per hour
+    double maxP99DriftPercent = 20.0;   // per hour
+    std::string csvFile;
+};
+
+struct SoakSample {
+    double time;
+    size_t rss;
+    HeapStats heap;
+    double p50;
+    double p99;
+    int frames;
+};
+
+struct Trend {
+    double slope = 0.0;     // units per second
+    double intercept = 0.0;
+};
+
+struct SoakInstance {
+    std::unique_ptr<rive::ArtboardInstance> artboard;
+    std::unique_ptr<rive::LinearAnimationInstance> animation;
+};
+
+// Ordinary least squares fit of y over x.
+static Trend fitTrend(const std::vector<double>& x, const std::vector<double>& y) {
+    Trend trend;
+    size_t n = x.size();
+    if (n < 2) {
+        return trend;
+    }
+    double meanX = 0.0, meanY = 0.0;
+    for (size_t i = 0; i < n; i++) {
+        meanX += x[i];
+        meanY += y[i];
+    }
+    meanX /= n;
+    meanY /= n;
+    double covariance = 0.0, variance = 0.0;
+    for (size_t i = 0; i < n; i++) {
+        covariance += (x[i] - meanX) * (y[i] - meanY);
+        variance += (x[i] - meanX) * (x[i] - meanX);
+    }
+    trend.slope = variance > 0 ? covariance / variance : 0.0;
+    trend.intercept = meanY - trend.slope * meanX;
+    return trend;
+}
+
+static SoakInstance createInstance(const CachedRiveFile& file) {
+    SoakInstance instance;
+    instance.artboard = file.instanceDefault();
+    if (instance.artboard && instance.artboard->animationCount() > 0) {
+        instance.animation = instance.artboard->animationAt(0);
+        instance.animation->time(0);
+        instance.animation->apply();
+    }
+    return instance;
+}
+
+static std::vector<CommandLineFlag> soakFlags(SoakOptions& options) {
+    return {
+        CommandLineFlag::number("--duration", "<s>", "Soak duration in seconds (default: 3600)", options.durationSeconds),
+        CommandLineFlag::number("--sample-interval", "<s>", "Seconds between samples (default: 10)", options.sampleInterval),
+        CommandLineFlag::number("--warmup", "<s>", "Samples ignored by the trend fit (default: 10% of duration, max 60)", options.warmupSeconds),
+        CommandLineFlag::number("--fps", "<n>", "Frame pacing, 0 = unpaced (default: 60)", options.fps),
+        CommandLineFlag::number("--instances", "<n>", "Live artboard instances (default: 8)", options.instances),
+        CommandLineFlag::number("--churn", "<frames>", "Recycle one instance every N frames, 0 = off (default: 30)", options.churnInterval),
+        CommandLineFlag::size("--render", "Rasterize every frame in software", options.renderWidth, options.renderHeight),
+        CommandLineFlag::number("--max-rss-growth", "<MB>", "Allowed RSS growth per hour (default: 1)", options.maxRssGrowthMB),
+        CommandLineFlag::number("--max-heap-growth", "<MB>", "Allowed heap growth per hour (default: 1)", options.maxHeapGrowthMB),
+        CommandLineFlag::number("--max-p99-drift", "<%>", "Allowed p99 frame time drift per hour (default: 20)", options.maxP99DriftPercent),
+        CommandLineFlag::text("--csv", "<file>", "Write every sample to a CSV file", options.csvFile),
+    };
+}
+
+static bool parseOptions(int argc, char* argv[], SoakOptions& options) {
+    if (!parseCommandLine(argc, argv, soakFlags(options), options.riveFile)) {
+        return false;
+    }
+    if (options.warmupSeconds < 0) {
+        options.warmupSeconds = std::min(60.0, options.durationSeconds * 0.1);
+    }
+    return options.durationSeconds > 0 && options.sampleInterval > 0 && options.instances > 0 &&
+           options.fps >= 0 && options.churnInterval >= 0;
+}
+
+int main(int argc, char* argv[]) {
+    SoakOptions options;
+    if (!parseOptions(argc, argv, options)) {
+        printCommandLineUsage(argv[0], soakFlags(options));
+        return -1;
+    }
+
+    std::cout << "Rive Soak Benchmark" << std::endl;
+    std::cout << "Loading: " << options.riveFile << std::endl;
+
+    bool passed = true;
+
+    try {
+        // Rendering needs a factory that keeps path geometry
+        std::unique_ptr<rive::Factory> factory;
+        if (options.renderWidth > 0 && options.renderHeight > 0) {
+            factory = std::make_unique<SoftwareFactory>();
+        } else {
+            factory = std::make_unique<rive::NoOpFactory>();
+        }
+        RiveFileCache cache(factory.get());
+        RiveFileCache::Entry riveFile = cache.load(options.riveFile).get();
+
+        std::vector<SoakInstance> instances;
+        for (int i = 0; i < options.instances; i++) {
+            instances.push_back(createInstance(*riveFile));
+            if (!instances.back().artboard) {
+                std::cerr << "No artboard found in Rive file" << std::endl;
+                return -1;
+            }
+        }
+
+        std::unique_ptr<Framebuffer> frame;
+        std::unique_ptr<SoftwareRenderer> renderer;
+        rive::Mat2D viewTransform;
+        if (options.renderWidth > 0 && options.renderHeight > 0) {
+            frame = std::make_unique<Framebuffer>(options.renderWidth, options.renderHeight);
+            renderer = std::make_unique<SoftwareRenderer>(*frame);
+            viewTransform = rive::computeAlignment(rive::Fit::contain, rive::Alignment::center,
+                                                   rive::AABB(0, 0, options.renderWidth, options.renderHeight),
+                                                   instances.front().artboard->bounds());
+        }
+
+        std::ofstream csv;
+        if (!options.csvFile.empty()) {
+            csv.open(options.csvFile);
+            if (!csv) {
+                std::cerr << "Failed to open CSV file: " << options.csvFile << std::endl;
+                return -1;
+            }
+            csv << "time_s,frames,rss_bytes,heap_in_use_bytes,heap_free_bytes,p50_ms,p99_ms" << std::endl;
+        }
+
+        std::cout << "Running " << options.durationSeconds << "-second soak test with " << options.instances
+                  << " instances" << std::endl;
+        std::cout << "Sampling every " << options.sampleInterval << " seconds, trend fit after "
+                  << options.warmupSeconds << " seconds of warmup" << std::endl;
+
+        // Paced runs step animations by the frame period; unpaced runs use measured time
+        const double pacedDelta = options.fps > 0 ? 1.0 / options.fps : 0.0;
+        std::vector<SoakSample> samples;
+        std::vector<double> windowFrameTimes;
+        long long frameCount = 0;
+        long long churned = 0;
+
+        auto startTime = std::chrono::high_resolution_clock::now();
+        auto testDuration = std::chrono::duration<double>(options.durationSeconds);
+        auto nextSample = startTime + std::chrono::duration_cast<std::chrono::high_resolution_clock::duration>(
+                                          std::chrono::duration<double>(options.sampleInterval));
+        auto nextFrame = startTime;
+        auto previousFrameStart = startTime;
+
+        while ((std::chrono::high_resolution_clock::now() - startTime) < testDuration) {
+            auto frameStart = std::chrono::high_resolution_clock::now();
+            double frameDelta = options.fps > 0
+                ? pacedDelta
+                : std::chrono::duration<double>(frameStart - previousFrameStart).count();
+            previousFrameStart = frameStart;
+
+            // Recycle one instance to exercise allocation and teardown
+            if (options.churnInterval > 0 && frameCount > 0 && frameCount % options.churnInterval == 0) {
+                SoakInstance& victim = instances[churned % instances.size()];
+                victim.animation.reset();
+                victim.artboard.reset();
+                victim = createInstance(*riveFile);
+                churned++;
+            }
+
+            for (auto& instance : instances) {
+                if (instance.animation) {
+                    instance.animation->advance(frameDelta);
+                    instance.animation->apply();
+                }
+                instance.artboard->advance(frameDelta);
+            }
+
+            if (renderer) {
+                frame->clear(0x00000000);
+                for (auto& instance : instances) {
+                    renderer->save();
+                    renderer->transform(viewTransform);
+                    instance.artboard->draw(renderer.get());
+                    renderer->restore();
+                }
+            }
+
+            auto frameEnd = std::chrono::high_resolution_clock::now();
+            windowFrameTimes.push_back(std::chrono::duration<double>(frameEnd - frameStart).count());
+            frameCount++;
+
+            if (frameEnd >= nextSample) {
+                SoakSample sample;
+                sample.time = std::chrono::duration<double>(frameEnd - startTime).count();
+                sample.rss = residentBytes();
+                sample.heap = heapStats();
+                sample.frames = (int)windowFrameTimes.size();
+                sample.p50 = percentile(windowFrameTimes, 50);
+                sample.p99 = percentile(windowFrameTimes, 99);
+                samples.push_back(sample);
+                windowFrameTimes.clear();
+
+                std::cout << "Sample " << samples.size() << " | t: " << (int)sample.time << "s"
+                          << " | RSS: " << sample.rss / (1024.0 * 1024.0) << " MB"
+                          << " | Heap: " << sample.heap.inUse / (1024.0 * 1024.0) << " MB"
+                          << " (free " << sample.heap.free / 1024.0 << " KB)"
+                          << " | p50: " << sample.p50 * 1000 << "ms"
+                          << " | p99: " << sample.p99 * 1000 << "ms" << std::endl;
+                if (csv.is_open()) {
+                    csv << sample.time << "," << sample.frames << "," << sample.rss << "," << sample.heap.inUse << ","
+                        << sample.heap.free << "," << sample.p50 * 1000 << "," << sample.p99 * 1000 << std::endl;
+                }
+
+                nextSample += std::chrono::duration_cast<std::chrono::high_resolution_clock::duration>(
+                    std::chrono::duration<double>(options.sampleInterval));
+            }
+
+            if (options.fps > 0) {
+                nextFrame += std::chrono::duration_cast<std::chrono::high_resolution_clock::duration>(
+                    std::chrono::duration<double>(pacedDelta));
+                // After a stall, resync instead of bursting frames to catch up
+                auto now = std::chrono::high_resolution_clock::now();
+                if (nextFrame < now) {
+                    nextFrame = now;
+                }
+                std::this_thread::sleep_until(nextFrame);
+            }
+        }
+
+        auto endTime = std::chrono::high_resolution_clock::now();
+        double actualDuration = std::chrono::duration<double>(endTime - startTime).count();
+
+        // Fit trends over post-warmup samples
+        std::vector<double> times, rss, heap, p99;
+        for (const SoakSample& sample : samples) {
+            if (sample.time < options.warmupSeconds) {
+                continue;
+            }
+            times.push_back(sample.time);
+            rss.push_back((double)sample.rss);
+            heap.push_back((double)sample.heap.inUse);
+            p99.push_back(sample.p99);
+        }
+
+        std::cout << "\n=== SOAK TEST RESULTS ===" << std::endl;
+        std::cout << "Test Duration: " << actualDuration << " seconds" << std::endl;
+        std::cout << "Total Frames: " << frameCount << std::endl;
+        std::cout << "Instances Recycled: " << churned << std::endl;
+        std::cout << "Samples: " << samples.size() << " (" << times.size() << " after warmup)" << std::endl;
+
+        if (times.size() < 3) {
+            std::cout << "Not enough post-warmup samples to fit trends; "
+                      << "increase --duration or reduce --sample-interval" << std::endl;
+            std::cout << "=========================" << std::endl;
+            return -1;
+        }
+
+        const double mb = 1024.0 * 1024.0;
+        Trend rssTrend = fitTrend(times, rss);
+        Trend heapTrend = fitTrend(times, heap);
+        Trend p99Trend = fitTrend(times, p99);
+
+        double rssGrowth = rssTrend.slope * 3600.0 / mb;
+        double heapGrowth = heapTrend.slope * 3600.0 / mb;
+        // Drift relative to the mean p99 (a fitted endpoint can be near zero on noisy data)
+        double p99Baseline = 0.0;
+        for (double value : p99) {
+            p99Baseline += value / p99.size();
+        }
+        double p99Drift = p99Baseline > 0 ? p99Trend.slope * 3600.0 / p99Baseline * 100.0 : 0.0;
+
+        auto check = [&](const char* name, double value, double limit, const char* unit) {
+            bool ok = value <= limit;
+            passed = passed && ok;
+            std::cout << name << ": " << value << " " << unit << " (limit " << limit << ") "
+                      << (ok ? "PASS" : "FAIL") << std::endl;
+        };
+        check("RSS Growth", rssGrowth, options.maxRssGrowthMB, "MB/hour");
+        check("Heap Growth", heapGrowth, options.maxHeapGrowthMB, "MB/hour");
+        check("p99 Drift", p99Drift, options.maxP99DriftPercent, "%/hour");
+
+        const SoakSample& first = samples.front();
+        const SoakSample& last = samples.back();
+        std::cout << "RSS: " << first.rss / mb << " MB -> " << last.rss / mb << " MB" << std::endl;
+        std::cout << "Heap In Use: " << first.heap.inUse / mb << " MB -> " << last.heap.inUse / mb << " MB" << std::endl;
+        std::cout << "Heap Free (fragmentation): " << first.heap.free / mb << " MB -> " << last.heap.free / mb << " MB" << std::endl;
+        std::cout << "p99 Frame Time: " << first.p99 * 1000 << " ms -> " << last.p99 * 1000 << " ms" << std::endl;
+        std::cout << "Result: " << (passed ? "PASS" : "FAIL") << std::endl;
+        std::cout << "=========================" << std::endl;
+
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return -1;
+    }
+
+    return passed ? 0 : -1;
+}
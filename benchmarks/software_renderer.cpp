@@ -0,0 +1,660 @@
+#include "software_renderer.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+void Framebuffer::clear(uint32_t argb) {
+    uint8_t a = (argb >> 24) & 0xFF;
+    uint8_t r = (argb >> 16) & 0xFF;
+    uint8_t g = (argb >> 8) & 0xFF;
+    uint8_t b = argb & 0xFF;
+    for (size_t i = 0; i < pixels.size(); i += 4) {
+        pixels[i + 0] = r;
+        pixels[i + 1] = g;
+        pixels[i + 2] = b;
+        pixels[i + 3] = a;
+    }
+}
+
+void SoftwareRenderPath::addRenderPath(rive::RenderPath* path, const rive::Mat2D& transform) {
+    auto* other = static_cast<SoftwareRenderPath*>(path);
+    rawPath.addPath(other->rawPath, &transform);
+}
+
+static inline float channel(rive::ColorInt c, int shift) {
+    return ((c >> shift) & 0xFF) / 255.0f;
+}
+
+rive::ColorInt SoftwareShader::colorAt(float x, float y) const {
+    if (colors.empty()) {
+        return 0;
+    }
+
+    float t;
+    if (type == Type::linear) {
+        float dx = x1 - x0;
+        float dy = y1 - y0;
+        float lengthSquared = dx * dx + dy * dy;
+        t = lengthSquared > 0 ? ((x - x0) * dx + (y - y0) * dy) / lengthSquared : 0.0f;
+    } else {
+        t = radius > 0 ? std::sqrt((x - x0) * (x - x0) + (y - y0) * (y - y0)) / radius : 0.0f;
+    }
+
+    if (t <= stops.front()) {
+        return colors.front();
+    }
+    if (t >= stops.back()) {
+        return colors.back();
+    }
+
+    size_t i = 1;
+    while (i < stops.size() - 1 && t > stops[i]) {
+        i++;
+    }
+    float span = stops[i] - stops[i - 1];
+    float f = span > 0 ? (t - stops[i - 1]) / span : 0.0f;
+
+    rive::ColorInt result = 0;
+    for (int shift = 0; shift < 32; shift += 8) {
+        float v = channel(colors[i - 1], shift) * (1 - f) + channel(colors[i], shift) * f;
+        result |= rive::ColorInt(v * 255.0f + 0.5f) << shift;
+    }
+    return result;
+}
+
+rive::rcp<rive::RenderShader> SoftwareFactory::makeLinearGradient(float sx, float sy, float ex, float ey,
+                                                                  const rive::ColorInt colors[],
+                                                                  const float stops[],
+                                                                  size_t count) {
+    return rive::make_rcp<SoftwareShader>(SoftwareShader::Type::linear, sx, sy, ex, ey, 0.0f,
+                                          colors, stops, count);
+}
+
+rive::rcp<rive::RenderShader> SoftwareFactory::makeRadialGradient(float cx, float cy, float radius,
+                                                                  const rive::ColorInt colors[],
+                                                                  const float stops[],
+                                                                  size_t count) {
+    return rive::make_rcp<SoftwareShader>(SoftwareShader::Type::radial, cx, cy, cx, cy, radius,
+                                          colors, stops, count);
+}
+
+rive::rcp<rive::RenderPath> SoftwareFactory::makeRenderPath(rive::RawPath& path, rive::FillRule rule) {
+    return rive::make_rcp<SoftwareRenderPath>(path, rule);
+}
+
+rive::rcp<rive::RenderPath> SoftwareFactory::makeEmptyRenderPath() {
+    return rive::make_rcp<SoftwareRenderPath>();
+}
+
+rive::rcp<rive::RenderPaint> SoftwareFactory::makeRenderPaint() {
+    return rive::make_rcp<SoftwareRenderPaint>();
+}
+
+SoftwareRenderer::SoftwareRenderer(Framebuffer& frame) : target(frame), coverage(frame.width + 1, 0.0f) {
+    stack.push_back(State{rive::Mat2D(), nullptr});
+}
+
+void SoftwareRenderer::save() {
+    stack.push_back(stack.back());
+}
+
+void SoftwareRenderer::restore() {
+    if (stack.size() > 1) {
+        stack.pop_back();
+    }
+}
+
+void SoftwareRenderer::transform(const rive::Mat2D& transform) {
+    stack.back().transform = stack.back().transform * transform;
+}
+
+namespace {
+
+struct Point {
+    float x, y;
+};
+
+inline Point apply(const rive::Mat2D& m, float x, float y) {
+    return {m[0] * x + m[2] * y + m[4], m[1] * x + m[3] * y + m[5]};
+}
+
+// Wang's formula: segments needed to keep a degree-n Bezier within tolerance.
+inline int segmentCount(float secondDifference, float degreeFactor, float tolerance) {
+    float n = std::ceil(std::sqrt(degreeFactor * secondDifference / tolerance));
+    return std::max(1, std::min(int(n), 128));
+}
+
+inline float length(float x, float y) {
+    return std::sqrt(x * x + y * y);
+}
+
+struct Contour {
+    std::vector<Point> points;
+    bool closed = false;
+};
+
+void flatten(const rive::RawPath& path, const rive::Mat2D& m, float tolerance,
+             std::vector<Contour>& contours) {
+    for (auto [verb, pts] : path) {
+        switch (verb) {
+            case rive::PathVerb::move:
+                contours.emplace_back();
+                contours.back().points.push_back(apply(m, pts[0].x, pts[0].y));
+                break;
+            case rive::PathVerb::line:
+                if (contours.empty()) {
+                    break;
+                }
+                contours.back().points.push_back(apply(m, pts[1].x, pts[1].y));
+                break;
+            case rive::PathVerb::quad: {
+                if (contours.empty()) {
+                    break;
+                }
+                Point p0 = apply(m, pts[0].x, pts[0].y);
+                Point p1 = apply(m, pts[1].x, pts[1].y);
+                Point p2 = apply(m, pts[2].x, pts[2].y);
+                int n = segmentCount(length(p0.x - 2 * p1.x + p2.x, p0.y - 2 * p1.y + p2.y),
+                                     0.25f, tolerance);
+                for (int i = 1; i <= n; i++) {
+                    float t = float(i) / n;
+                    float u = 1 - t;
+                    contours.back().points.push_back({u * u * p0.x + 2 * u * t * p1.x + t * t * p2.x,
+                                                      u * u * p0.y + 2 * u * t * p1.y + t * t * p2.y});
+                }
+                break;
+            }
+            case rive::PathVerb::cubic: {
+                if (contours.empty()) {
+                    break;
+                }
+                Point p0 = apply(m, pts[0].x, pts[0].y);
+                Point p1 = apply(m, pts[1].x, pts[1].y);
+                Point p2 = apply(m, pts[2].x, pts[2].y);
+                Point p3 = apply(m, pts[3].x, pts[3].y);
+                float d = std::max(length(p0.x - 2 * p1.x + p2.x, p0.y - 2 * p1.y + p2.y),
+                                   length(p1.x - 2 * p2.x + p3.x, p1.y - 2 * p2.y + p3.y));
+                int n = segmentCount(d, 0.75f, tolerance);
+                for (int i = 1; i <= n; i++) {
+                    float t = float(i) / n;
+                    float u = 1 - t;
+                    float a = u * u * u, b = 3 * u * u * t, c = 3 * u * t * t, e = t * t * t;
+                    contours.back().points.push_back({a * p0.x + b * p1.x + c * p2.x + e * p3.x,
+                                                      a * p0.y + b * p1.y + c * p2.y + e * p3.y});
+                }
+                break;
+            }
+            case rive::PathVerb::close:
+                if (!contours.empty()) {
+                    contours.back().closed = true;
+                }
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+inline void addEdge(std::vector<SoftwareRenderer::Edge>& edges, Point a, Point b) {
+    if (a.y == b.y) {
+        return;
+    }
+    if (a.y < b.y) {
+        edges.push_back({a.x, a.y, b.x, b.y, 1});
+    } else {
+        edges.push_back({b.x, b.y, a.x, a.y, -1});
+    }
+}
+
+// Adds a closed polygon wound like every other stroke piece, so overlapping
+// pieces union under the non-zero rule instead of cancelling.
+void addPolygon(std::vector<SoftwareRenderer::Edge>& edges, const std::vector<Point>& p) {
+    float area = 0;
+    for (size_t i = 0; i < p.size(); i++) {
+        const Point& a = p[i];
+        const Point& b = p[(i + 1) % p.size()];
+        area += a.x * b.y - b.x * a.y;
+    }
+    for (size_t i = 0; i < p.size(); i++) {
+        const Point& a = p[i];
+        const Point& b = p[(i + 1) % p.size()];
+        if (area > 0) {
+            addEdge(edges, b, a);
+        } else {
+            addEdge(edges, a, b);
+        }
+    }
+}
+
+// Appends points on an arc around c, with chords within tolerance of it.
+void appendArc(std::vector<Point>& out, Point c, float radius, float start, float sweep,
+               float tolerance) {
+    float maxStep = 2 * std::acos(std::max(-1.0f, 1 - tolerance / radius));
+    int n = std::max(1, std::min(int(std::ceil(std::abs(sweep) / maxStep)), 128));
+    for (int i = 0; i <= n; i++) {
+        float angle = start + sweep * i / n;
+        out.push_back({c.x + radius * std::cos(angle), c.y + radius * std::sin(angle)});
+    }
+}
+
+struct StrokeStyle {
+    float halfWidth;
+    rive::StrokeJoin join;
+    rive::StrokeCap cap;
+    float tolerance;
+};
+
+constexpr float kPi = 3.14159265f;
+
+// Miters longer than this many half widths fall back to bevels (SVG default).
+constexpr float kMiterLimit = 4.0f;
+
+// Fills the wedge on the outside of the turn at p from direction d0 to d1.
+void addJoin(std::vector<SoftwareRenderer::Edge>& edges, std::vector<Point>& poly, Point p,
+             Point d0, Point d1, const StrokeStyle& style) {
+    float cross = d0.x * d1.y - d0.y * d1.x;
+    float dot = d0.x * d1.x + d0.y * d1.y;
+    if (std::abs(cross) < 1e-6f && dot > 0) {
+        return;
+    }
+
+    float hw = style.halfWidth;
+    float side = cross > 0 ? -hw : hw;
+    Point o0 = {-d0.y * side, d0.x * side};
+    Point o1 = {-d1.y * side, d1.x * side};
+
+    poly.clear();
+    poly.push_back(p);
+    if (style.join == rive::StrokeJoin::round) {
+        float start = std::atan2(o0.y, o0.x);
+        float sweep = std::atan2(o0.x * o1.y - o0.y * o1.x, o0.x * o1.x + o0.y * o1.y);
+        appendArc(poly, p, hw, start, sweep, style.tolerance);
+    } else {
+        poly.push_back({p.x + o0.x, p.y + o0.y});
+        float cosHalf = std::sqrt(std::max(0.0f, (1 + dot) * 0.5f));
+        if (style.join == rive::StrokeJoin::miter && cosHalf * kMiterLimit >= 1) {
+            Point mid = {o0.x + o1.x, o0.y + o1.y};
+            float scale = hw / (cosHalf * length(mid.x, mid.y));
+            poly.push_back({p.x + mid.x * scale, p.y + mid.y * scale});
+        }
+        poly.push_back({p.x + o1.x, p.y + o1.y});
+    }
+    addPolygon(edges, poly);
+}
+
+// Extends an open end at p outward along unit direction u.
+void addCap(std::vector<SoftwareRenderer::Edge>& edges, std::vector<Point>& poly, Point p, Point u,
+            const StrokeStyle& style) {
+    float hw = style.halfWidth;
+    Point n = {-u.y * hw, u.x * hw};
+    poly.clear();
+    if (style.cap == rive::StrokeCap::square) {
+        poly.push_back({p.x + n.x, p.y + n.y});
+        poly.push_back({p.x + n.x + u.x * hw, p.y + n.y + u.y * hw});
+        poly.push_back({p.x - n.x + u.x * hw, p.y - n.y + u.y * hw});
+        poly.push_back({p.x - n.x, p.y - n.y});
+    } else if (style.cap == rive::StrokeCap::round) {
+        // Half circle from n through u to -n
+        appendArc(poly, p, hw, std::atan2(n.y, n.x), -kPi, style.tolerance);
+    } else {
+        return;
+    }
+    addPolygon(edges, poly);
+}
+
+void strokeContour(std::vector<SoftwareRenderer::Edge>& edges, const Contour& contour,
+                   const StrokeStyle& style) {
+    // Zero-length segments have no direction; drop repeated points.
+    std::vector<Point> p;
+    for (const Point& point : contour.points) {
+        if (p.empty() || length(point.x - p.back().x, point.y - p.back().y) > 1e-4f) {
+            p.push_back(point);
+        }
+    }
+    if (contour.closed && p.size() > 1 && length(p.front().x - p.back().x, p.front().y - p.back().y) <= 1e-4f) {
+        p.pop_back();
+    }
+    if (p.empty()) {
+        return;
+    }
+
+    std::vector<Point> poly;
+    if (p.size() == 1) {
+        // A lone point only shows its caps, as a dot or square
+        addCap(edges, poly, p[0], {-1, 0}, style);
+        addCap(edges, poly, p[0], {1, 0}, style);
+        return;
+    }
+
+    size_t segments = contour.closed ? p.size() : p.size() - 1;
+    std::vector<Point> directions(segments);
+    for (size_t i = 0; i < segments; i++) {
+        Point a = p[i];
+        Point b = p[(i + 1) % p.size()];
+        float len = length(b.x - a.x, b.y - a.y);
+        Point d = {(b.x - a.x) / len, (b.y - a.y) / len};
+        directions[i] = d;
+
+        float nx = -d.y * style.halfWidth;
+        float ny = d.x * style.halfWidth;
+        poly = {{a.x + nx, a.y + ny}, {b.x + nx, b.y + ny}, {b.x - nx, b.y - ny}, {a.x - nx, a.y - ny}};
+        addPolygon(edges, poly);
+    }
+
+    if (contour.closed) {
+        for (size_t i = 0; i < segments; i++) {
+            addJoin(edges, poly, p[i], directions[(i + segments - 1) % segments], directions[i], style);
+        }
+    } else {
+        for (size_t i = 1; i < segments; i++) {
+            addJoin(edges, poly, p[i], directions[i - 1], directions[i], style);
+        }
+        addCap(edges, poly, p.front(), {-directions.front().x, -directions.front().y}, style);
+        addCap(edges, poly, p.back(), directions.back(), style);
+    }
+}
+
+} // namespace
+
+void SoftwareRenderer::buildEdges(const rive::RawPath& path, const rive::Mat2D& matrix,
+                                  const SoftwareRenderPaint* stroke) {
+    std::vector<Contour> contours;
+    flatten(path, matrix, flatteningTolerance, contours);
+
+    edges.clear();
+    if (!stroke) {
+        // Every contour is implicitly closed for filling.
+        for (const Contour& contour : contours) {
+            const auto& p = contour.points;
+            for (size_t i = 0; i < p.size(); i++) {
+                addEdge(edges, p[i], p[(i + 1) % p.size()]);
+            }
+        }
+        return;
+    }
+
+    // Strokes are the union of a quad per flattened segment plus join and cap
+    // polygons, all filled together under the non-zero rule.
+    float scale = std::sqrt(std::abs(matrix[0] * matrix[3] - matrix[1] * matrix[2]));
+    StrokeStyle style;
+    style.halfWidth = std::max(stroke->thicknessValue * scale, 0.5f) * 0.5f;
+    style.join = stroke->joinValue;
+    style.cap = stroke->capValue;
+    style.tolerance = flatteningTolerance;
+    for (const Contour& contour : contours) {
+        strokeContour(edges, contour, style);
+    }
+}
+
+template <typename RowFn>
+void SoftwareRenderer::rasterize(rive::FillRule rule, RowFn&& row) {
+    if (edges.empty()) {
+        return;
+    }
+
+    std::sort(edges.begin(), edges.end(), [](const Edge& a, const Edge& b) { return a.y0 < b.y0; });
+
+    float maxY = 0;
+    for (const Edge& e : edges) {
+        maxY = std::max(maxY, e.y1);
+    }
+    int yStart = std::max(0, int(std::floor(edges.front().y0)));
+    int yEnd = std::min(target.height, int(std::ceil(maxY)));
+
+    const int width = target.width;
+    const bool antialias = samplesPerPixel > 1;
+    const float sampleWeight = 1.0f / samplesPerPixel;
+
+    std::vector<const Edge*> active;
+    std::vector<std::pair<float, int>> crossings;
+    size_t nextEdge = 0;
+
+    for (int y = yStart; y < yEnd; y++) {
+        // Retire edges that ended above this row and admit those starting in it.
+        active.erase(std::remove_if(active.begin(), active.end(),
+                                    [y](const Edge* e) { return e->y1 <= y; }),
+                     active.end());
+        while (nextEdge < edges.size() && edges[nextEdge].y0 < y + 1) {
+            if (edges[nextEdge].y1 > y) {
+                active.push_back(&edges[nextEdge]);
+            }
+            nextEdge++;
+        }
+        if (active.empty()) {
+            continue;
+        }
+
+        int minX = width;
+        int maxX = -1;
+
+        for (int s = 0; s < samplesPerPixel; s++) {
+            float sy = y + (s + 0.5f) * sampleWeight;
+            crossings.clear();
+            for (const Edge* e : active) {
+                if (sy >= e->y0 && sy < e->y1) {
+                    float x = e->x0 + (sy - e->y0) * (e->x1 - e->x0) / (e->y1 - e->y0);
+                    crossings.emplace_back(x, e->winding);
+                }
+            }
+            std::sort(crossings.begin(), crossings.end());
+
+            int winding = 0;
+            for (size_t i = 0; i + 1 < crossings.size(); i++) {
+                winding += crossings[i].second;
+                bool inside = rule == rive::FillRule::evenOdd ? (winding & 1) != 0 : winding != 0;
+                if (!inside) {
+                    continue;
+                }
+
+                float xa = crossings[i].first;
+                float xb = crossings[i + 1].first;
+                if (!antialias) {
+                    xa = std::round(xa);
+                    xb = std::round(xb);
+                }
+                xa = std::max(xa, 0.0f);
+                xb = std::min(xb, float(width));
+                if (xb <= xa) {
+                    continue;
+                }
+
+                int ia = int(xa);
+                int ib = int(xb);
+                if (ia == ib) {
+                    coverage[ia] += (xb - xa) * sampleWeight;
+                } else {
+                    coverage[ia] += (ia + 1 - xa) * sampleWeight;
+                    for (int x = ia + 1; x < ib; x++) {
+                        coverage[x] += sampleWeight;
+                    }
+                    coverage[ib] += (xb - ib) * sampleWeight;
+                }
+                minX = std::min(minX, ia);
+                maxX = std::max(maxX, std::min(ib, width - 1));
+            }
+        }
+
+        if (maxX >= minX) {
+            row(y, minX, maxX, coverage.data());
+            std::fill(coverage.begin() + minX, coverage.begin() + maxX + 2, 0.0f);
+        }
+    }
+}
+
+void SoftwareRenderer::drawPath(rive::RenderPath* path, rive::RenderPaint* paint) {
+    auto* softwarePath = static_cast<SoftwareRenderPath*>(path);
+    auto* softwarePaint = static_cast<SoftwareRenderPaint*>(paint);
+    const State& state = stack.back();
+
+    bool stroke = softwarePaint->styleValue == rive::RenderPaintStyle::stroke;
+    buildEdges(softwarePath->rawPath, state.transform, stroke ? softwarePaint : nullptr);
+    if (softwarePaint->featherValue > 0) {
+        unsupportedUsed |= unsupportedFeather;
+    }
+    if (softwarePaint->blendModeValue != rive::BlendMode::srcOver) {
+        unsupportedUsed |= unsupportedBlendMode;
+    }
+
+    const SoftwareShader* shader = softwarePaint->shaderValue.get();
+    rive::Mat2D inverse;
+    if (shader && !state.transform.invert(&inverse)) {
+        return;
+    }
+
+    const std::vector<uint8_t>* clip = state.clip.get();
+    rive::ColorInt solid = softwarePaint->colorValue;
+    rive::FillRule rule = stroke ? rive::FillRule::nonZero : softwarePath->fillRuleValue;
+
+    rasterize(rule, [&](int y, int minX, int maxX, const float* cover) {
+        uint8_t* dst = target.pixels.data() + (size_t(y) * target.width + minX) * 4;
+        const uint8_t* clipRow = clip ? clip->data() + size_t(y) * target.width : nullptr;
+        for (int x = minX; x <= maxX; x++, dst += 4) {
+            float a = std::min(cover[x], 1.0f);
+            if (clipRow) {
+                a *= clipRow[x] / 255.0f;
+            }
+            if (a <= 0) {
+                continue;
+            }
+
+            rive::ColorInt c = solid;
+            if (shader) {
+                Point local = apply(inverse, x + 0.5f, y + 0.5f);
+                c = shader->colorAt(local.x, local.y);
+            }
+
+            float srcA = channel(c, 24) * a;
+            float dstA = dst[3] / 255.0f;
+            float outA = srcA + dstA * (1 - srcA);
+            if (outA <= 0) {
+                continue;
+            }
+            for (int k = 0; k < 3; k++) {
+                float src = channel(c, 16 - 8 * k);
+                float d = dst[k] / 255.0f;
+                dst[k] = uint8_t(((src * srcA + d * dstA * (1 - srcA)) / outA) * 255.0f + 0.5f);
+            }
+            dst[3] = uint8_t(outA * 255.0f + 0.5f);
+        }
+    });
+}
+
+std::string SoftwareRenderer::describeUnsupported(uint32_t features) {
+    std::string names;
+    auto add = [&](UnsupportedFeature feature, const char* name) {
+        if (features & feature) {
+            names += names.empty() ? name : std::string(", ") + name;
+        }
+    };
+    add(unsupportedImages, "images (skipped)");
+    add(unsupportedFeather, "feathering (drawn hard-edged)");
+    add(unsupportedBlendMode, "blend modes (drawn as source-over)");
+    return names;
+}
+
+void SoftwareRenderer::clipPath(rive::RenderPath* path) {
+    auto* softwarePath = static_cast<SoftwareRenderPath*>(path);
+    State& state = stack.back();
+
+    buildEdges(softwarePath->rawPath, state.transform, nullptr);
+
+    auto mask = std::make_shared<std::vector<uint8_t>>(size_t(target.width) * target.height, 0);
+    const std::vector<uint8_t>* previous = state.clip.get();
+
+    rasterize(softwarePath->fillRuleValue, [&](int y, int minX, int maxX, const float* cover) {
+        size_t offset = size_t(y) * target.width;
+        for (int x = minX; x <= maxX; x++) {
+            float a = std::min(cover[x], 1.0f);
+            if (previous) {
+                a *= (*previous)[offset + x] / 255.0f;
+            }
+            (*mask)[offset + x] = uint8_t(a * 255.0f + 0.5f);
+        }
+    });
+
+    state.clip = std::move(mask);
+}
+
+namespace {
+
+uint32_t crc32(const uint8_t* data, size_t length, uint32_t crc = 0) {
+    static uint32_t table[256];
+    static bool initialized = [] {
+        for (uint32_t i = 0; i < 256; i++) {
+            uint32_t c = i;
+            for (int k = 0; k < 8; k++) {
+                c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            }
+            table[i] = c;
+        }
+        return true;
+    }();
+    (void)initialized;
+
+    crc = ~crc;
+    for (size_t i = 0; i < length; i++) {
+        crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+void putBE32(std::vector<uint8_t>& out, uint32_t v) {
+    out.push_back(v >> 24);
+    out.push_back(v >> 16);
+    out.push_back(v >> 8);
+    out.push_back(v);
+}
+
+void writeChunk(std::vector<uint8_t>& out, const char type[4], const std::vector<uint8_t>& data) {
+    putBE32(out, uint32_t(data.size()));
+    size_t start = out.size();
+    out.insert(out.end(), type, type + 4);
+    out.insert(out.end(), data.begin(), data.end());
+    putBE32(out, crc32(out.data() + start, out.size() - start));
+}
+
+} // namespace
+
+std::vector<uint8_t> encodePNG(const Framebuffer& frame) {
+    std::vector<uint8_t> out = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+
+    std::vector<uint8_t> header;
+    putBE32(header, frame.width);
+    putBE32(header, frame.height);
+    header.insert(header.end(), {8, 6, 0, 0, 0}); // 8-bit RGBA, no interlace
+    writeChunk(out, "IHDR", header);
+
+    // Scanlines prefixed with filter type 0, wrapped in stored deflate blocks.
+    size_t stride = size_t(frame.width) * 4;
+    std::vector<uint8_t> raw;
+    raw.reserve((stride + 1) * frame.height);
+    for (int y = 0; y < frame.height; y++) {
+        raw.push_back(0);
+        const uint8_t* row = frame.pixels.data() + y * stride;
+        raw.insert(raw.end(), row, row + stride);
+    }
+
+    std::vector<uint8_t> zlib = {0x78, 0x01};
+    uint32_t a = 1, b = 0;
+    for (uint8_t byte : raw) {
+        a = (a + byte) % 65521;
+        b = (b + a) % 65521;
+    }
+    size_t offset = 0;
+    do {
+        size_t block = std::min<size_t>(raw.size() - offset, 65535);
+        bool final = offset + block == raw.size();
+        zlib.push_back(final ? 1 : 0);
+        zlib.push_back(block & 0xFF);
+        zlib.push_back(block >> 8);
+        zlib.push_back(~block & 0xFF);
+        zlib.push_back((~block >> 8) & 0xFF);
+        zlib.insert(zlib.end(), raw.begin() + offset, raw.begin() + offset + block);
+        offset += block;
+    } while (offset < raw.size());
+    putBE32(zlib, (b << 16) | a);
+    writeChunk(out, "IDAT", zlib);
+
+    writeChunk(out, "IEND", {});
+    return out;
+}
@@ -0,0 +1,190 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "rive/renderer.hpp"
+#include "rive/math/mat2d.hpp"
+#include "rive/math/raw_path.hpp"
+#include "utils/no_op_factory.hpp"
+
+// Headless CPU rasterizer for Rive. It needs no window, GL context or OpenVG
+// device, so it can be used for offline frame export and on machines without
+// a display. Paths are flattened to polylines and scan-converted with
+// supersampled coverage. Strokes support miter/round/bevel joins and
+// butt/square/round caps; paints support solid colors and linear/radial
+// gradients composited with source-over.
+//
+// Not supported (SoftwareRenderer::unsupportedFeatures() reports use):
+//  - images and image meshes, which are skipped
+//  - feathered paints, which are drawn with hard edges
+//  - blend modes other than source-over, which are drawn as source-over
+// Stroke widths under a non-uniform scale use the transform's average scale.
+
+// RGBA8 frame (straight, non-premultiplied alpha), rows top to bottom.
+struct Framebuffer {
+    int width = 0;
+    int height = 0;
+    std::vector<uint8_t> pixels;
+
+    Framebuffer(int w, int h) : width(w), height(h), pixels(size_t(w) * h * 4, 0) {}
+
+    void clear(uint32_t argb);
+};
+
+class SoftwareRenderPath : public rive::RenderPath {
+public:
+    rive::RawPath rawPath;
+    rive::FillRule fillRuleValue;
+
+    explicit SoftwareRenderPath(rive::FillRule rule = rive::FillRule::nonZero) : fillRuleValue(rule) {}
+    SoftwareRenderPath(rive::RawPath& path, rive::FillRule rule) : fillRuleValue(rule) {
+        rawPath.swap(path);
+    }
+
+    void rewind() override { rawPath.rewind(); }
+    void fillRule(rive::FillRule value) override { fillRuleValue = value; }
+    void addRenderPath(rive::RenderPath* path, const rive::Mat2D& transform) override;
+    void addRawPath(const rive::RawPath& path) override { rawPath.addPath(path); }
+    void moveTo(float x, float y) override { rawPath.moveTo(x, y); }
+    void lineTo(float x, float y) override { rawPath.lineTo(x, y); }
+    void cubicTo(float ox, float oy, float ix, float iy, float x, float y) override {
+        rawPath.cubicTo(ox, oy, ix, iy, x, y);
+    }
+    void close() override { rawPath.close(); }
+};
+
+class SoftwareShader : public rive::RenderShader {
+public:
+    enum class Type { linear, radial };
+
+    Type type;
+    float x0, y0;      // linear start / radial center
+    float x1, y1;      // linear end
+    float radius;      // radial radius
+    std::vector<rive::ColorInt> colors;
+    std::vector<float> stops;
+
+    SoftwareShader(Type t, float ax, float ay, float bx, float by, float r,
+                   const rive::ColorInt c[], const float s[], size_t count)
+        : type(t), x0(ax), y0(ay), x1(bx), y1(by), radius(r),
+          colors(c, c + count), stops(s, s + count) {}
+
+    // Returns the ARGB color at a point in the shader's local space.
+    rive::ColorInt colorAt(float x, float y) const;
+};
+
+class SoftwareRenderPaint : public rive::RenderPaint {
+public:
+    rive::RenderPaintStyle styleValue = rive::RenderPaintStyle::fill;
+    rive::ColorInt colorValue = 0xFF000000;
+    float thicknessValue = 1.0f;
+    rive::StrokeJoin joinValue = rive::StrokeJoin::miter;
+    rive::StrokeCap capValue = rive::StrokeCap::butt;
+    float featherValue = 0.0f;                               // not rasterized
+    rive::BlendMode blendModeValue = rive::BlendMode::srcOver; // not rasterized
+    rive::rcp<SoftwareShader> shaderValue;
+
+    void style(rive::RenderPaintStyle value) override { styleValue = value; }
+    void color(rive::ColorInt value) override { colorValue = value; }
+    void thickness(float value) override { thicknessValue = value; }
+    void join(rive::StrokeJoin value) override { joinValue = value; }
+    void cap(rive::StrokeCap value) override { capValue = value; }
+    void feather(float value) override { featherValue = value; }
+    void blendMode(rive::BlendMode value) override { blendModeValue = value; }
+    void shader(rive::rcp<rive::RenderShader> value) override {
+        shaderValue = rive::static_rcp_cast<SoftwareShader>(std::move(value));
+    }
+    void invalidateStroke() override {}
+};
+
+// Factory that records path geometry and paint state for SoftwareRenderer.
+// Buffers and image decoding are inherited from NoOpFactory.
+class SoftwareFactory : public rive::NoOpFactory {
+public:
+    rive::rcp<rive::RenderShader> makeLinearGradient(float sx, float sy, float ex, float ey,
+                                                     const rive::ColorInt colors[],
+                                                     const float stops[],
+                                                     size_t count) override;
+    rive::rcp<rive::RenderShader> makeRadialGradient(float cx, float cy, float radius,
+                                                     const rive::ColorInt colors[],
+                                                     const float stops[],
+                                                     size_t count) override;
+    rive::rcp<rive::RenderPath> makeRenderPath(rive::RawPath& path, rive::FillRule rule) override;
+    rive::rcp<rive::RenderPath> makeEmptyRenderPath() override;
+    rive::rcp<rive::RenderPaint> makeRenderPaint() override;
+};
+
+class SoftwareRenderer : public rive::Renderer {
+public:
+    explicit SoftwareRenderer(Framebuffer& target);
+
+    // Quality knobs; coarser tolerance and no antialiasing trade fidelity for speed.
+    void setFlatteningTolerance(float pixels) { flatteningTolerance = pixels; }
+    void setAntialias(bool enabled) { samplesPerPixel = enabled ? 4 : 1; }
+
+    // Features a draw asked for that were skipped or approximated.
+    enum UnsupportedFeature : uint32_t {
+        unsupportedImages = 1 << 0,
+        unsupportedFeather = 1 << 1,
+        unsupportedBlendMode = 1 << 2,
+    };
+    // Bitmask of UnsupportedFeature seen since construction.
+    uint32_t unsupportedFeatures() const { return unsupportedUsed; }
+    static std::string describeUnsupported(uint32_t features);
+
+    void save() override;
+    void restore() override;
+    void transform(const rive::Mat2D& transform) override;
+    void drawPath(rive::RenderPath* path, rive::RenderPaint* paint) override;
+    void clipPath(rive::RenderPath* path) override;
+    void drawImage(const rive::RenderImage* image, rive::ImageSampler sampler,
+                   rive::BlendMode blendMode, float opacity) override {
+        unsupportedUsed |= unsupportedImages;
+    }
+    void drawImageMesh(const rive::RenderImage* image,
+                       rive::ImageSampler sampler,
+                       rive::rcp<rive::RenderBuffer> vertices_f32,
+                       rive::rcp<rive::RenderBuffer> uvCoords_f32,
+                       rive::rcp<rive::RenderBuffer> indices_u16,
+                       uint32_t vertexCount,
+                       uint32_t indexCount,
+                       rive::BlendMode blendMode,
+                       float opacity) override {
+        unsupportedUsed |= unsupportedImages;
+    }
+
+    struct Edge {
+        float x0, y0, x1, y1;
+        int winding;
+    };
+
+private:
+    struct State {
+        rive::Mat2D transform;
+        std::shared_ptr<const std::vector<uint8_t>> clip; // null = unclipped
+    };
+
+    Framebuffer& target;
+    std::vector<State> stack;
+    std::vector<Edge> edges;      // reused between draws
+    std::vector<float> coverage;  // one row of accumulated coverage
+
+    // Max deviation, in pixels, between a curve and its flattened polyline.
+    float flatteningTolerance = 0.25f;
+    // Sub-scanlines sampled per pixel row.
+    int samplesPerPixel = 4;
+    uint32_t unsupportedUsed = 0;
+
+    // A null paint builds fill edges.
+    void buildEdges(const rive::RawPath& path, const rive::Mat2D& matrix,
+                    const SoftwareRenderPaint* stroke);
+
+    template <typename RowFn>
+    void rasterize(rive::FillRule rule, RowFn&& row);
+};
+
+// Encodes a frame as an uncompressed (stored-deflate) RGBA PNG.
+std::vector<uint8_t> encodePNG(const Framebuffer& frame);
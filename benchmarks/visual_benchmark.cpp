@@ -12,6 +12,9 @@
 #include "rive/animation/linear_animation_instance.hpp"
 #include "rive/factory.hpp"
 #include "utils/no_op_factory.hpp"
+#include "software_renderer.hpp"
+#include "frame_governor.hpp"
+#include "rive_file_cache.hpp"
 
 // OpenGL and X11 headers (after Rive to avoid None conflict)
 #include <GL/gl.h>
@@ -120,6 +123,34 @@ public:
         glClear(GL_COLOR_BUFFER_BIT);
     }
     
+    void presentFramebuffer(const Framebuffer& frame) {
+        // Blit a software-rendered frame, upscaled to fill the window
+        glMatrixMode(GL_PROJECTION);
+        glPushMatrix();
+        glLoadIdentity();
+        glOrtho(0, windowWidth, 0, windowHeight, -1, 1);
+        glMatrixMode(GL_MODELVIEW);
+        glPushMatrix();
+        glLoadIdentity();
+        
+        // Rows are stored top-down, so start at the top-left corner and zoom
+        // downwards. glBitmap moves the raster position without clipping it.
+        glRasterPos2i(0, 0);
+        glBitmap(0, 0, 0, 0, 0, (float)windowHeight, nullptr);
+        glPixelZoom((float)windowWidth / frame.width, -(float)windowHeight / frame.height);
+        
+        glEnable(GL_BLEND);
+        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        glDrawPixels(frame.width, frame.height, GL_RGBA, GL_UNSIGNED_BYTE, frame.pixels.data());
+        glDisable(GL_BLEND);
+        glPixelZoom(1.0f, 1.0f);
+        
+        glPopMatrix();
+        glMatrixMode(GL_PROJECTION);
+        glPopMatrix();
+        glMatrixMode(GL_MODELVIEW);
+    }
+    
     void drawTestPattern() {
         // Always draw a test pattern so we know OpenGL is working
         static float testTime = 0.0f;
@@ -354,6 +385,7 @@ private:
     GLXContext glContext;
     int windowWidth;
     int windowHeight;
+    bool focused = true;
     
 public:
     RiveWindow(int width, int height) : windowWidth(width), windowHeight(height) {
@@ -400,7 +432,7 @@ public:
         swa.colormap = XCreateColormap(display, RootWindow(display, vi->screen), vi->visual, AllocNone);
         swa.background_pixmap = 0L;
         swa.border_pixel = 0;
-        swa.event_mask = StructureNotifyMask | KeyPressMask;
+        swa.event_mask = StructureNotifyMask | KeyPressMask | FocusChangeMask;
         
         window = XCreateWindow(display, RootWindow(display, vi->screen),
                               0, 0, windowWidth, windowHeight, 0, vi->depth, InputOutput,
@@ -447,6 +479,10 @@ public:
             XNextEvent(display, &xev);
             if (xev.type == KeyPress) {
                 return false; // Exit on any key press
+            } else if (xev.type == FocusIn) {
+                focused = true;
+            } else if (xev.type == FocusOut) {
+                focused = false;
             }
         }
         return true;
@@ -454,6 +490,7 @@ public:
     
     int getWidth() const { return windowWidth; }
     int getHeight() const { return windowHeight; }
+    bool hasFocus() const { return focused; }
 };
 
 int main(int argc, char* argv[]) {
@@ -462,39 +499,42 @@ int main(int argc, char* argv[]) {
         riveFile = argv[1];
     }
     
+    // --benchmark: run for 3 seconds
+    // --governor: software rendering with adaptive quality against the frame budget
+    bool benchmark_mode = false;
+    bool governor_mode = false;
+    for (int i = 2; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--benchmark") {
+            benchmark_mode = true;
+        } else if (arg == "--governor") {
+            governor_mode = true;
+        }
+    }
+    
     std::cout << "Rive Visual Test" << std::endl;
     std::cout << "Loading: " << riveFile << std::endl;
     std::cout << "Press any key to exit" << std::endl;
     
     try {
-        // Create window
-        RiveWindow window(800, 600);
-        
-        // Load the .riv file
-        std::ifstream file(riveFile, std::ios::binary);
-        if (!file) {
-            std::cerr << "Failed to open Rive file: " << riveFile << std::endl;
-            return -1;
+        // Start importing on the cache's loader thread (governor mode rasterizes
+        // real geometry, so keep it) while the window and GL context come up
+        std::unique_ptr<rive::Factory> factory;
+        if (governor_mode) {
+            factory = std::make_unique<SoftwareFactory>();
+        } else {
+            factory = std::make_unique<rive::NoOpFactory>();
         }
+        RiveFileCache cache(factory.get());
+        auto pendingFile = cache.load(riveFile);
         
-        file.seekg(0, std::ios::end);
-        size_t length = file.tellg();
-        file.seekg(0, std::ios::beg);
+        // Create window
+        RiveWindow window(800, 600);
         
-        std::vector<uint8_t> bytes(length);
-        file.read(reinterpret_cast<char*>(bytes.data()), length);
-        file.close();
-        
-        // Import the Rive file
-        rive::NoOpFactory factory;
-        auto riveFilePtr = rive::File::import(rive::Span<const uint8_t>(bytes.data(), bytes.size()), &factory);
-        if (!riveFilePtr) {
-            std::cerr << "Failed to import Rive file" << std::endl;
-            return -1;
-        }
+        RiveFileCache::Entry riveFilePtr = pendingFile.get();
         
         // Get the artboard
-        auto artboard = riveFilePtr->artboardDefault();
+        auto artboard = riveFilePtr->instanceDefault();
         if (!artboard) {
             std::cerr << "No artboard found in Rive file" << std::endl;
             return -1;
@@ -522,9 +562,34 @@ int main(int argc, char* argv[]) {
         auto startTime = std::chrono::high_resolution_clock::now();
         
         // Run for 3 seconds for benchmarking, or until user input
-        bool benchmark_mode = (argc > 2 && std::string(argv[2]) == "--benchmark");
         auto benchmark_duration = std::chrono::seconds(3);
         
+        // Governor state: software render target sized by the current quality level
+        const double frameBudget = 1.0 / 60.0;
+        FrameGovernor governor(frameBudget);
+        std::unique_ptr<Framebuffer> softwareFrame;
+        std::unique_ptr<SoftwareRenderer> softwareRenderer;
+        rive::Mat2D softwareViewTransform;
+        auto applyQualityLevel = [&]() {
+            const QualityLevel& quality = governor.level();
+            int width = std::max(1, (int)(window.getWidth() * quality.renderScale));
+            int height = std::max(1, (int)(window.getHeight() * quality.renderScale));
+            softwareFrame = std::make_unique<Framebuffer>(width, height);
+            softwareRenderer = std::make_unique<SoftwareRenderer>(*softwareFrame);
+            softwareRenderer->setFlatteningTolerance(quality.flatteningTolerance);
+            softwareRenderer->setAntialias(quality.antialias);
+            softwareViewTransform = rive::computeAlignment(rive::Fit::contain, rive::Alignment::center,
+                                                           rive::AABB(0, 0, width, height), artboard->bounds());
+        };
+        if (governor_mode) {
+            applyQualityLevel();
+            std::cout << "Governor enabled | Budget: " << frameBudget * 1000 << "ms | Level: "
+                      << governor.level().name << std::endl;
+        }
+        auto lastFrameTime = startTime;
+        double pendingAdvance = 0.0;
+        int skippedUpdates = 0;
+        
         // Real-time FPS calculation
         std::string rendererName = (const char*)glGetString(GL_RENDERER);
         double currentFPS = 0.0;
@@ -535,27 +600,53 @@ int main(int argc, char* argv[]) {
                (!benchmark_mode || (std::chrono::high_resolution_clock::now() - startTime) < benchmark_duration)) {
             auto frameStart = std::chrono::high_resolution_clock::now();
             
-            // Update animation
-            if (animation) {
-                animation->advance(1.0 / 60.0); // Advance by 1/60th of a second
-                animation->apply();
+            if (governor_mode) {
+                // Advance by real elapsed time so late frames don't slow the animation
+                pendingAdvance += std::chrono::duration<double>(frameStart - lastFrameTime).count();
+                lastFrameTime = frameStart;
+                
+                // Off-focus windows only update every Nth frame at reduced levels
+                if (window.hasFocus() || ++skippedUpdates >= governor.level().offFocusUpdateDivisor) {
+                    if (animation) {
+                        animation->advance(pendingAdvance);
+                        animation->apply();
+                    }
+                    artboard->advance(pendingAdvance);
+                    pendingAdvance = 0.0;
+                    skippedUpdates = 0;
+                }
+                
+                renderer.setupViewport();
+                
+                softwareFrame->clear(0x00000000);
+                softwareRenderer->save();
+                softwareRenderer->transform(softwareViewTransform);
+                artboard->draw(softwareRenderer.get());
+                softwareRenderer->restore();
+                renderer.presentFramebuffer(*softwareFrame);
+            } else {
+                // Update animation
+                if (animation) {
+                    animation->advance(1.0 / 60.0); // Advance by 1/60th of a second
+                    animation->apply();
+                }
+                
+                // Render
+                renderer.setupViewport();
+                
+                // Always draw test pattern first
+                renderer.drawTestPattern();
+                
+                // Apply artboard transform to center it
+                renderer.save();
+                renderer.transform(rive::Mat2D::fromScale(1.0f, 1.0f)); // Keep original scale
+                
+                // Draw the artboard
+                artboard->draw(&renderer);
+                
+                renderer.restore();
             }
             
-            // Render
-            renderer.setupViewport();
-            
-            // Always draw test pattern first
-            renderer.drawTestPattern();
-            
-            // Apply artboard transform to center it
-            renderer.save();
-            renderer.transform(rive::Mat2D::fromScale(1.0f, 1.0f)); // Keep original scale
-            
-            // Draw the artboard
-            artboard->draw(&renderer);
-            
-            renderer.restore();
-            
             auto frameEnd = std::chrono::high_resolution_clock::now();
             double frameTime = std::chrono::duration<double>(frameEnd - frameStart).count();
             
@@ -577,11 +668,33 @@ int main(int argc, char* argv[]) {
             // Draw performance HUD on top
             renderer.drawPerformanceHUD(currentFPS, frameTime, rendererName);
             
+            auto workEnd = std::chrono::high_resolution_clock::now();
+
             // Swap buffers
             window.swapBuffers();
             
             // Target 60 FPS
-            std::this_thread::sleep_for(std::chrono::milliseconds(16));
+            if (governor_mode) {
+                // Judge the work done before the swap: with vsync every interval
+                // is about one refresh long, so it would always read as over
+                // budget. An interval that overran by half a refresh missed a
+                // vblank, and counts in full.
+                auto presentEnd = std::chrono::high_resolution_clock::now();
+                double workTime = std::chrono::duration<double>(workEnd - frameStart).count();
+                double interval = std::chrono::duration<double>(presentEnd - frameStart).count();
+                if (governor.addFrame(interval > frameBudget * 1.5 ? interval : workTime)) {
+                    applyQualityLevel();
+                }
+                
+                // Only sleep off whatever is left of the budget
+                auto now = std::chrono::high_resolution_clock::now();
+                double remaining = frameBudget - std::chrono::duration<double>(now - frameStart).count();
+                if (remaining > 0) {
+                    std::this_thread::sleep_for(std::chrono::duration<double>(remaining));
+                }
+            } else {
+                std::this_thread::sleep_for(std::chrono::milliseconds(16));
+            }
         }
         
         // Print final performance results with renderer information
@@ -590,6 +703,11 @@ int main(int argc, char* argv[]) {
         std::cout << "Renderer Type: " << (rendererName.find("llvmpipe") != std::string::npos ? "SOFTWARE (CPU)" : "HARDWARE (GPU)") << std::endl;
         std::cout << "Final Real-time FPS: " << (int)currentFPS << std::endl;
         std::cout << "Average Frame Time: " << (metrics.frameCount > 0 ? (metrics.totalTime / metrics.frameCount) * 1000 : 0) << " ms" << std::endl;
+        if (governor_mode) {
+            std::cout << "Governor Level: " << governor.level().name << " (" << governor.levelIndex() + 1
+                      << "/" << governor.levelCount() << ")" << std::endl;
+            std::cout << "Governor Transitions: " << governor.transitionCount() << std::endl;
+        }
         std::cout << "=================================" << std::endl;
         
         metrics.print("OpenGL Renderer");